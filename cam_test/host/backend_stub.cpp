@@ -0,0 +1,233 @@
+#include "backend_stub.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+// Códigos e mensagens do endpoint no backend Flask de teste (backend_test.py).
+// O resto é aproximado: lá a rota desconhecida recebe a página HTML padrão de 404
+// do Flask e não existe 503, que aqui só vem de setAvailable(false).
+static const char* const BODY_OK = "{\"message\":\"Ponto registrado com sucesso no backend de teste.\",\"status\":\"Success\"}";
+static const char* const BODY_UNAUTHORIZED = "{\"message\":\"Token inv\\u00e1lido\",\"status\":\"error\"}";
+static const char* const BODY_NO_AUTH = "{\"message\":\"Header de autoriza\\u00e7\\u00e3o faltando\",\"status\":\"error\"}";
+static const char* const BODY_SERVER_ERROR = "{\"message\":\"Erro interno do servidor\",\"status\":\"error\"}";
+static const char* const BODY_NOT_FOUND = "{\"message\":\"Rota n\\u00e3o encontrada\",\"status\":\"error\"}";
+static const char* const BODY_UNAVAILABLE = "{\"message\":\"Servidor indispon\\u00edvel\",\"status\":\"error\"}";
+
+static std::string makeResponse(int code, const char* reason, const char* body) {
+    std::string r = "HTTP/1.1 " + std::to_string(code) + " " + reason + "\r\n";
+    r += "Content-Type: application/json\r\nConnection: keep-alive\r\nContent-Length: ";
+    r += std::to_string(strlen(body));
+    r += "\r\n\r\n";
+    r += body;
+    return r;
+}
+
+BackendStub::BackendStub(const FaultConfig& faults, const std::string& path, const std::string& token)
+    : faults_(faults), path_(path), token_(token), rng_(faults.seed) {}
+
+BackendStub::~BackendStub() {
+    stop();
+}
+
+bool BackendStub::start(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 128) != 0) {
+        ::close(fd);
+        return false;
+    }
+    socklen_t len = sizeof(addr);
+    getsockname(fd, (sockaddr*)&addr, &len);
+    port_ = ntohs(addr.sin_port);
+
+    listenFd_ = fd;
+    setEpoch(std::chrono::steady_clock::now());
+    running_ = true;
+    acceptThread_ = std::thread(&BackendStub::acceptLoop, this);
+    return true;
+}
+
+void BackendStub::stop() {
+    if (!running_.exchange(false)) return;
+    shutdown(listenFd_, SHUT_RDWR);
+    if (acceptThread_.joinable()) acceptThread_.join();
+    ::close(listenFd_);
+    listenFd_ = -1;
+
+    std::unique_lock<std::mutex> lock(connMutex_);
+    for (int fd : connFds_) shutdown(fd, SHUT_RDWR);
+    connDone_.wait(lock, [this] { return activeConns_ == 0; });
+}
+
+BackendStats BackendStub::stats() const {
+    BackendStats s;
+    s.requests = requests_;
+    s.accepted = accepted_;
+    s.rejected = rejected_;
+    s.dropped = dropped_;
+    s.unavailable = unavailable_;
+    s.refused = refused_;
+    s.bytesIn = bytesIn_;
+    s.bytesOut = bytesOut_;
+    s.connections = connections_;
+    return s;
+}
+
+void BackendStub::setEpoch(std::chrono::steady_clock::time_point epoch) {
+    std::lock_guard<std::mutex> lock(acceptMutex_);
+    epoch_ = epoch;
+}
+
+std::vector<double> BackendStub::acceptedAtMs() const {
+    std::lock_guard<std::mutex> lock(acceptMutex_);
+    return acceptedAtMs_;
+}
+
+void BackendStub::acceptLoop() {
+    while (running_) {
+        pollfd p{listenFd_, POLLIN, 0};
+        if (poll(&p, 1, 100) <= 0) continue;
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) continue;
+        if (!available_) { // conexão recusada
+            refused_++;
+            ::close(fd);
+            continue;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        connections_++;
+        std::lock_guard<std::mutex> lock(connMutex_);
+        connFds_.push_back(fd);
+        activeConns_++;
+        std::thread(&BackendStub::serveConnection, this, fd).detach();
+    }
+}
+
+uint32_t BackendStub::nextDelayMs(bool& drop) {
+    std::lock_guard<std::mutex> lock(rngMutex_);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    drop = faults_.loss > 0.0 && u(rng_) < faults_.loss;
+    uint32_t delay = faults_.latencyMs;
+    if (faults_.jitterMs > 0) delay += std::uniform_int_distribution<uint32_t>(0, faults_.jitterMs)(rng_);
+    return delay;
+}
+
+void BackendStub::serveConnection(int fd) {
+    std::string buf;
+    char tmp[8192];
+    bool open = true;
+
+    while (open && running_) {
+        // 1. Cabeçalhos
+        size_t headerEnd;
+        while ((headerEnd = buf.find("\r\n\r\n")) == std::string::npos) {
+            ssize_t n = recv(fd, tmp, sizeof(tmp), 0);
+            if (n <= 0) { open = false; break; }
+            buf.append(tmp, (size_t)n);
+        }
+        if (!open) break;
+
+        size_t eol = buf.find("\r\n");
+        std::string requestLine = buf.substr(0, eol);
+        size_t contentLength = 0;
+        std::string auth;
+        size_t pos = eol + 2;
+        while (pos < headerEnd) {
+            size_t next = buf.find("\r\n", pos);
+            std::string h = buf.substr(pos, next - pos);
+            if (strncasecmp(h.c_str(), "Content-Length:", 15) == 0) {
+                contentLength = (size_t)strtoul(h.c_str() + 15, nullptr, 10);
+            } else if (strncasecmp(h.c_str(), "Authorization:", 14) == 0) {
+                auth = h.substr(14);
+                while (!auth.empty() && auth.front() == ' ') auth.erase(0, 1);
+            }
+            pos = next + 2;
+        }
+
+        // 2. Corpo
+        size_t total = headerEnd + 4 + contentLength;
+        while (buf.size() < total) {
+            ssize_t n = recv(fd, tmp, sizeof(tmp), 0);
+            if (n <= 0) { open = false; break; }
+            buf.append(tmp, (size_t)n);
+        }
+        if (!open) break;
+
+        std::string body = buf.substr(headerEnd + 4, contentLength);
+        buf.erase(0, total);
+        requests_++;
+        bytesIn_ += total;
+
+        // 3. Injeção de falhas
+        bool drop = false;
+        uint32_t delayMs = nextDelayMs(drop);
+        if (drop) {
+            // A resposta "se perde": o cliente só descobre pelo timeout
+            dropped_++;
+            continue;
+        }
+        if (delayMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+
+        // 4. Validação, na mesma ordem do backend de teste
+        std::string resp;
+        if (!available_) {
+            resp = makeResponse(503, "Service Unavailable", BODY_UNAVAILABLE);
+            unavailable_++;
+        } else if (requestLine.compare(0, 5 + path_.size(), "POST " + path_) != 0) {
+            resp = makeResponse(404, "Not Found", BODY_NOT_FOUND);
+            rejected_++;
+        } else if (auth.compare(0, 7, "Bearer ") != 0) {
+            resp = makeResponse(401, "Unauthorized", BODY_NO_AUTH);
+            rejected_++;
+        } else if (auth.substr(7, auth.find(' ', 7) - 7) != token_) {
+            // Como auth_header.split(" ")[1] no Flask
+            resp = makeResponse(401, "Unauthorized", BODY_UNAUTHORIZED);
+            rejected_++;
+        } else if (body.empty() || body.front() != '{' || body.back() != '}') {
+            // request.get_json() falha (ou não é objeto) e o Flask responde 500; sem
+            // image_b64 ele ainda aceita, então o campo não é verificado aqui
+            resp = makeResponse(500, "Internal Server Error", BODY_SERVER_ERROR);
+            rejected_++;
+        } else {
+            resp = makeResponse(200, "OK", BODY_OK);
+            accepted_++;
+            std::lock_guard<std::mutex> lock(acceptMutex_);
+            acceptedAtMs_.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - epoch_).count());
+        }
+
+        size_t off = 0;
+        while (off < resp.size()) {
+            ssize_t n = send(fd, resp.data() + off, resp.size() - off, MSG_NOSIGNAL);
+            if (n <= 0) { open = false; break; }
+            off += (size_t)n;
+        }
+        bytesOut_ += off;
+    }
+
+    std::lock_guard<std::mutex> lock(connMutex_);
+    for (auto it = connFds_.begin(); it != connFds_.end(); ++it) {
+        if (*it == fd) { connFds_.erase(it); break; }
+    }
+    ::close(fd);
+    activeConns_--;
+    connDone_.notify_all();
+}
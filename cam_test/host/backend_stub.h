@@ -0,0 +1,87 @@
+#pragma once
+
+// Substituto local do endpoint /api/v1/attendance (ponto-backend/backend_test.py)
+// com injeção de falhas: latência, perda de requisições e indisponibilidade.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct FaultConfig {
+    uint32_t latencyMs = 0; // atraso fixo antes de responder
+    uint32_t jitterMs = 0;  // atraso extra uniforme em [0, jitterMs]
+    double loss = 0.0;      // probabilidade de a resposta nunca chegar
+    uint32_t seed = 1;
+};
+
+struct BackendStats {
+    uint64_t requests = 0;
+    uint64_t accepted = 0; // respondidas com 200
+    uint64_t rejected = 0;    // 401/404/500 da validação, como no backend de teste
+    uint64_t unavailable = 0; // 503 enquanto setAvailable(false)
+    uint64_t refused = 0;     // conexões fechadas sem resposta enquanto setAvailable(false)
+    uint64_t dropped = 0;     // perdidas por injeção de falha
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    uint64_t connections = 0;
+};
+
+class BackendStub {
+public:
+    BackendStub(const FaultConfig& faults, const std::string& path, const std::string& token);
+    ~BackendStub();
+    BackendStub(const BackendStub&) = delete;
+    BackendStub& operator=(const BackendStub&) = delete;
+
+    // port = 0 escolhe uma porta livre; use port() para consultá-la
+    bool start(uint16_t port);
+    void stop();
+    uint16_t port() const { return port_; }
+
+    // Simula indisponibilidade do servidor: novas conexões e requisições são recusadas
+    void setAvailable(bool available) { available_ = available; }
+
+    BackendStats stats() const;
+
+    // Instantes das respostas 200, em ms desde a referência (start() ou setEpoch()),
+    // para medir a vazão do lado do servidor e não pela confirmação no cliente
+    void setEpoch(std::chrono::steady_clock::time_point epoch);
+    std::vector<double> acceptedAtMs() const;
+
+private:
+    void acceptLoop();
+    void serveConnection(int fd);
+    uint32_t nextDelayMs(bool& drop);
+
+    FaultConfig faults_;
+    std::string path_;
+    std::string token_;
+
+    int listenFd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> available_{true};
+    std::thread acceptThread_;
+
+    // Threads de conexão são destacadas; stop() espera activeConns_ chegar a zero
+    std::mutex connMutex_;
+    std::condition_variable connDone_;
+    std::vector<int> connFds_;
+    size_t activeConns_ = 0;
+
+    mutable std::mutex acceptMutex_;
+    std::chrono::steady_clock::time_point epoch_;
+    std::vector<double> acceptedAtMs_;
+
+    std::mutex rngMutex_;
+    std::mt19937 rng_;
+
+    std::atomic<uint64_t> requests_{0}, accepted_{0}, rejected_{0}, unavailable_{0}, refused_{0}, dropped_{0};
+    std::atomic<uint64_t> bytesIn_{0}, bytesOut_{0}, connections_{0};
+};
@@ -0,0 +1,136 @@
+// Driver de replay: alimenta um corpus de frames gravado pelo firmware
+// (ENABLE_CORPUS_CAPTURE) através do pipeline completo (gating de captura,
+// payload, fila offline e envio) contra um backend local com falhas injetadas.
+//
+// Uso:
+//   corpus_replay --corpus DIR [--latency-ms N] [--jitter-ms N] [--loss P]
+//                 [--outage INICIO_MS:DURACAO_MS]... [--seed N] [--no-keepalive]
+//                 [--server-outage INICIO_MS:DURACAO_MS]... [--backend HOST:PORTA]
+//                 [--drain-limit-ms N]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "attendance_payload.h"
+#include "backend_stub.h"
+#include "device_sim.h"
+#include "host_common.h"
+#include "stats.h"
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Uso: %s --corpus DIR [--latency-ms N] [--jitter-ms N] [--loss P]\n"
+            "          [--outage INICIO_MS:DURACAO_MS]... [--seed N] [--no-keepalive]\n"
+            "          [--server-outage INICIO_MS:DURACAO_MS]... [--backend HOST:PORTA]\n"
+            "          [--drain-limit-ms N]\n",
+            argv0);
+}
+
+int main(int argc, char** argv) {
+    std::string corpusDir;
+    std::string backend;
+    FaultConfig faults;
+    OutageSchedule outages;
+    OutageSchedule serverOutages;
+    DeviceConfig dev;
+    uint64_t drainLimitMs = 10 * 60 * 1000;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--corpus" && hasValue) corpusDir = argv[++i];
+        else if (a == "--latency-ms" && hasValue) faults.latencyMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--jitter-ms" && hasValue) faults.jitterMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--loss" && hasValue) faults.loss = strtod(argv[++i], nullptr);
+        else if (a == "--seed" && hasValue) faults.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--backend" && hasValue) backend = argv[++i];
+        else if (a == "--drain-limit-ms" && hasValue) drainLimitMs = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--no-keepalive") dev.keepAlive = false;
+        else if (a == "--outage" && hasValue) {
+            if (!outages.add(argv[++i])) { usage(argv[0]); return 2; }
+        } else if (a == "--server-outage" && hasValue) {
+            if (!serverOutages.add(argv[++i])) { usage(argv[0]); return 2; }
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (corpusDir.empty()) { usage(argv[0]); return 2; }
+    if (!backend.empty() && serverOutages.size() > 0) {
+        fprintf(stderr, "[ERRO] --server-outage só se aplica ao backend local.\n");
+        return 2;
+    }
+
+    std::vector<CorpusFrame> frames;
+    uint32_t sessions = 0;
+    if (!loadCorpus(corpusDir, frames, sessions)) return 1;
+
+    // Backend: stub local com falhas injetadas, ou um servidor externo (ex.: backend_test.py)
+    BackendStub stub(faults, dev.path, dev.token);
+    if (!selectBackend(backend, stub, dev)) return 1;
+
+    DeviceSim sim(dev, [&outages](double nowMs) { return !outages.active(nowMs); });
+    applyServerOutages(sim, stub, serverOutages);
+
+    // Replay: o frame i fica disponível no mesmo offset em que foi capturado no dispositivo.
+    // Entre frames (ex.: aguardando ativação BLE) o loop() continua rodando e drenando a fila.
+    auto wallStart = std::chrono::steady_clock::now();
+    double nowMs = 0;
+    uint64_t jpegBytes = 0;
+    for (const auto& f : frames) {
+        while (nowMs < f.atMs) {
+            double next = sim.idle(nowMs);
+            nowMs = (next >= f.atMs) ? next : std::min(next + CAPTURE_OVERRUN_REST_MS, (double)f.atMs);
+        }
+        nowMs = sim.step(nowMs, f.jpeg.data(), f.jpeg.size());
+        jpegBytes += f.jpeg.size();
+    }
+    double replayEndMs = nowMs;
+
+    // Fim do corpus: continua o loop sem captura até a fila offline esvaziar
+    while (sim.queueLen() > 0 && nowMs - replayEndMs < drainLimitMs) {
+        nowMs = sim.idle(nowMs) + CAPTURE_OVERRUN_REST_MS;
+    }
+    double hostSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    const DeviceStats& s = sim.stats();
+    uint64_t acked = s.sentRealtime + s.drained;
+
+    printf("=== Replay do corpus: %s ===\n", corpusDir.c_str());
+    printf("Backend: %s:%u%s\n", dev.host.c_str(), dev.port, backend.empty() ? " (stub local)" : "");
+    printf("Falhas: latência=%ums jitter=%ums perda=%.3f quedas=%zu (servidor=%zu) seed=%u keep-alive=%s\n",
+           faults.latencyMs, faults.jitterMs, faults.loss, outages.size(), serverOutages.size(), faults.seed, dev.keepAlive ? "sim" : "não");
+    printf("Corpus: %zu frames em %u sessão(ões), %llu bytes JPEG (média %.0f B)\n",
+           frames.size(), sessions, (unsigned long long)jpegBytes, (double)jpegBytes / frames.size());
+    printf("\nRegistros:\n");
+    printf("  capturados=%llu  tempo-real=%llu  fila-offline=%llu  drenados=%llu  pendentes=%zu\n",
+           (unsigned long long)s.frames, (unsigned long long)s.sentRealtime, (unsigned long long)s.queuedOffline,
+           (unsigned long long)s.drained, sim.queueLen());
+    printf("  POSTs falhos=%llu  falhas de conexão=%llu  conexões TCP=%u\n",
+           (unsigned long long)s.failedPosts, (unsigned long long)s.connectFailures, sim.connectCount());
+    printf("  pico da fila: %zu linhas, %llu bytes (SPIFFS gravado: %llu bytes)\n",
+           s.peakQueueLen, (unsigned long long)s.peakQueueBytes, (unsigned long long)s.offlineBytesWritten);
+    printf("\nVazão:\n");
+    printf("  %.3f registros/s (relógio do dispositivo, %.1f s)\n", nowMs > 0 ? acked * 1000.0 / nowMs : 0.0, nowMs / 1000.0);
+    printf("  (execução no host: %.2f s; o relógio virtual não espera as pausas do loop)\n", hostSec);
+    printf("\nLatência:\n");
+    printLatencyLine("POST (RTT)", s.rttMs);
+    printLatencyLine("captura -> confirmação", s.e2eMs);
+    printf("\nBytes na rede:\n");
+    printf("  enviados=%llu  recebidos=%llu  por registro confirmado=%.0f\n",
+           (unsigned long long)s.bytesSent, (unsigned long long)s.bytesReceived,
+           acked ? (double)(s.bytesSent + s.bytesReceived) / acked : 0.0);
+
+    if (backend.empty()) {
+        BackendStats b = stub.stats();
+        stub.stop();
+        printBackendReport(b);
+    }
+
+    // Código de saída != 0 se algum registro não foi entregue, para uso em scripts de regressão
+    return sim.queueLen() == 0 ? 0 : 3;
+}
@@ -0,0 +1,139 @@
+#include "device_sim.h"
+
+#include <chrono>
+#include <ctime>
+
+#include "attendance_payload.h"
+
+using SteadyClock = std::chrono::steady_clock;
+
+static double elapsedMs(SteadyClock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(SteadyClock::now() - t0).count();
+}
+
+DeviceSim::DeviceSim(const DeviceConfig& cfg, std::function<bool(double)> linkUp)
+    : cfg_(cfg), linkUp_(std::move(linkUp)) {}
+
+std::string DeviceSim::isoAt(double nowMs) const {
+    time_t t = (time_t)(cfg_.epochBaseSec + (uint64_t)(nowMs / 1000));
+    struct tm timeinfo;
+    gmtime_r(&t, &timeinfo);
+    char buf[32];
+    strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &timeinfo);
+    return std::string(buf);
+}
+
+bool DeviceSim::post(const std::string& json, double& nowMs) {
+    if (beforePost_) beforePost_(nowMs);
+    auto t0 = SteadyClock::now();
+    bool ok = false;
+
+    if (!client_.connected()) {
+        if (!client_.connect(cfg_.host, cfg_.port)) {
+            stats_.connectFailures++;
+            stats_.failedPosts++;
+            nowMs += elapsedMs(t0);
+            return false;
+        }
+    }
+
+    std::string req = makeAttendanceRequest(cfg_.host.c_str(), cfg_.path.c_str(), cfg_.token.c_str(), json);
+    if (client_.write(req)) {
+        stats_.bytesSent += req.size();
+        std::string status;
+        size_t bytesRead = 0;
+        if (client_.readResponse(HTTP_RESPONSE_TIMEOUT_MS, status, bytesRead)) {
+            stats_.bytesReceived += bytesRead;
+            ok = isHttpSuccessStatus(status);
+        }
+    }
+    if (!cfg_.keepAlive) client_.stop();
+
+    double rtt = elapsedMs(t0);
+    nowMs += rtt;
+    if (ok) {
+        stats_.rttMs.push_back(rtt);
+        stats_.ackAtMs.push_back(nowMs);
+    } else {
+        stats_.failedPosts++;
+    }
+    return ok;
+}
+
+double DeviceSim::maybeDrain(double nowMs) {
+    // Mesma condição do loop(): Wi-Fi conectado e SYNC_INTERVAL_MS desde a última tentativa
+    if (!linkUp_(nowMs) || nowMs - lastSyncAttemptMs_ <= SYNC_INTERVAL_MS) return nowMs;
+    lastSyncAttemptMs_ = nowMs;
+    if (queue_.empty()) return nowMs;
+
+    // Percorre a fila inteira uma vez; falhas voltam para o fim, como em tryDrainOfflineQueue
+    size_t pending = queue_.size();
+    for (size_t i = 0; i < pending; i++) {
+        QueuedLine line = std::move(queue_.front());
+        queue_.pop_front();
+
+        bool ok = linkUp_(nowMs) && post(line.json, nowMs);
+        if (ok) {
+            stats_.drained++;
+            stats_.e2eMs.push_back(nowMs - line.capturedAtMs);
+            queueBytes_ -= line.storedBytes;
+        } else {
+            queue_.push_back(std::move(line));
+        }
+    }
+    return nowMs;
+}
+
+double DeviceSim::maintainLink(double nowMs) {
+    // connectWiFi() bloqueia até reconectar ou estourar o timeout
+    if (!linkUp_(nowMs)) {
+        double start = nowMs;
+        while (!linkUp_(nowMs) && nowMs - start < WIFI_CONNECT_TIMEOUT_MS) nowMs += WIFI_CONNECT_POLL_MS;
+        if (waitUntil_) waitUntil_(nowMs);
+    }
+    return nowMs;
+}
+
+double DeviceSim::step(double nowMs, const uint8_t* jpeg, size_t len) {
+    // 1. Manutenção do Wi-Fi
+    nowMs = maintainLink(nowMs);
+
+    // 3. Drenagem da fila offline
+    nowMs = maybeDrain(nowMs);
+
+    // 5. Captura
+    double capturedAtMs = nowMs;
+    stats_.frames++;
+
+    // 6. Codificação e montagem do payload
+    auto tEncode = SteadyClock::now();
+    std::string imgB64 = base64Encode(jpeg, len);
+    bool online = linkUp_(nowMs);
+    std::string payload = makeAttendanceJson(imgB64, isoAt(nowMs), cfg_.roomId, cfg_.courseId, online ? "realtime" : "offline", "");
+    nowMs += elapsedMs(tEncode);
+
+    // 7. Envio ou armazenamento
+    double tStart = nowMs;
+    bool ok = online && post(payload, nowMs);
+    if (ok) {
+        stats_.sentRealtime++;
+        stats_.e2eMs.push_back(nowMs - capturedAtMs);
+    } else {
+        size_t stored = offlineLineSize(payload.size());
+        stats_.queuedOffline++;
+        stats_.offlineBytesWritten += stored;
+        queueBytes_ += stored;
+        queue_.push_back({std::move(payload), capturedAtMs, stored});
+        if (queue_.size() > stats_.peakQueueLen) stats_.peakQueueLen = queue_.size();
+        if (queueBytes_ > stats_.peakQueueBytes) stats_.peakQueueBytes = queueBytes_;
+    }
+
+    // 8. Pacing entre capturas
+    double elapsed = nowMs - tStart;
+    double rest = (elapsed < CAPTURE_MIN_INTERVAL_MS) ? (CAPTURE_MIN_INTERVAL_MS - elapsed) : (double)CAPTURE_OVERRUN_REST_MS;
+    return nowMs + rest;
+}
+
+double DeviceSim::idle(double nowMs) {
+    return maybeDrain(maintainLink(nowMs));
+}
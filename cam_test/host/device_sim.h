@@ -0,0 +1,94 @@
+#pragma once
+
+// Réplica em host do loop() do firmware: gating de captura, montagem do
+// payload, fila offline e envio/drenagem. Usa as mesmas funções de
+// lib/attendance que o firmware, e um relógio virtual em milissegundos que
+// avança pelas pausas do loop e pelo tempo real gasto em rede/codificação.
+// O relógio é double para não perder a fração de cada POST/codificação.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "http_client.h"
+
+struct DeviceConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 3000;
+    std::string path = "/api/v1/attendance";
+    std::string token = "e83z9XyJk4mFpA6hD7qWc2sT1uVb0R3g";
+    std::string roomId = "SALA_101";
+    std::string courseId = "DISCIPLINA_ABC123";
+    // Epoch (s) correspondente ao instante virtual 0, usado nos timestamps ISO
+    uint64_t epochBaseSec = 1704067200;
+    // false = fecha a conexão após cada resposta (sem keep-alive)
+    bool keepAlive = true;
+};
+
+struct DeviceStats {
+    uint64_t frames = 0;
+    uint64_t sentRealtime = 0;   // POST direto bem-sucedido
+    uint64_t queuedOffline = 0;  // linhas gravadas na fila offline
+    uint64_t drained = 0;        // linhas da fila enviadas com sucesso
+    uint64_t failedPosts = 0;    // POSTs sem resposta 2xx (timeout, recusa, 4xx/5xx)
+    uint64_t connectFailures = 0;
+    uint64_t bytesSent = 0;      // bytes de requisição escritos no socket
+    uint64_t bytesReceived = 0;  // bytes de resposta lidos
+    uint64_t offlineBytesWritten = 0;
+    size_t peakQueueLen = 0;
+    uint64_t peakQueueBytes = 0;
+    std::vector<double> rttMs;   // duração de cada POST com resposta 2xx
+    std::vector<double> e2eMs;   // captura -> confirmação do servidor (relógio virtual)
+    std::vector<double> ackAtMs; // instante virtual de cada resposta 2xx (paralelo a rttMs)
+};
+
+class DeviceSim {
+public:
+    // linkUp(nowMs) informa se o Wi-Fi está conectado no instante virtual
+    DeviceSim(const DeviceConfig& cfg, std::function<bool(double)> linkUp);
+
+    // Uma iteração de loop() com o frame capturado em nowMs. Retorna o instante
+    // virtual em que a próxima captura pode ocorrer (após o delay de pacing).
+    double step(double nowMs, const uint8_t* jpeg, size_t len);
+
+    // Iteração de loop() sem captura (ex.: aguardando ativação BLE): manutenção
+    // do Wi-Fi e drenagem a cada SYNC_INTERVAL_MS. Retorna o instante após a tentativa.
+    double idle(double nowMs);
+
+    // Chamado quando o relógio virtual avança sem trabalho (ex.: espera do
+    // connectWiFi). O replay não define o hook; o gerador de carga dorme até o instante.
+    void setWaitHook(std::function<void(double)> waitUntil) { waitUntil_ = std::move(waitUntil); }
+
+    // Chamado antes de cada POST com o instante virtual; os drivers usam para
+    // aplicar quedas do servidor (--server-outage) no relógio do dispositivo.
+    void setPostHook(std::function<void(double)> beforePost) { beforePost_ = std::move(beforePost); }
+
+    size_t queueLen() const { return queue_.size(); }
+    const DeviceStats& stats() const { return stats_; }
+    uint32_t connectCount() const { return client_.connectCount(); }
+
+private:
+    struct QueuedLine {
+        std::string json;
+        double capturedAtMs;
+        size_t storedBytes;
+    };
+
+    double maintainLink(double nowMs);
+    double maybeDrain(double nowMs);
+    bool post(const std::string& json, double& nowMs);
+    std::string isoAt(double nowMs) const;
+
+    DeviceConfig cfg_;
+    std::function<bool(double)> linkUp_;
+    std::function<void(double)> waitUntil_;
+    std::function<void(double)> beforePost_;
+    HttpClient client_;
+    std::deque<QueuedLine> queue_;
+    uint64_t queueBytes_ = 0;
+    double lastSyncAttemptMs_ = 0;
+    DeviceStats stats_;
+};
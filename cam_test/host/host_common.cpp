@@ -0,0 +1,101 @@
+#include "host_common.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include "http_client.h"
+
+bool loadCorpus(const std::string& dir, std::vector<CorpusFrame>& frames, uint32_t& sessions) {
+    std::ifstream idx(dir + "/index.csv");
+    if (!idx) {
+        fprintf(stderr, "[ERRO] Índice do corpus não encontrado em %s/index.csv\n", dir.c_str());
+        return false;
+    }
+    std::string line;
+    while (std::getline(idx, line)) {
+        CorpusFrame f;
+        if (!parseCorpusIndexLine(line, f.entry)) continue;
+        std::ifstream jpg(dir + "/" + f.entry.file, std::ios::binary);
+        if (!jpg) {
+            fprintf(stderr, "[ERRO] Frame ausente: %s\n", f.entry.file.c_str());
+            return false;
+        }
+        f.jpeg.assign(std::istreambuf_iterator<char>(jpg), std::istreambuf_iterator<char>());
+        if (f.jpeg.size() != f.entry.len) {
+            fprintf(stderr, "[ERRO] Tamanho divergente em %s (%zu != %zu)\n", f.entry.file.c_str(), f.jpeg.size(), f.entry.len);
+            return false;
+        }
+        frames.push_back(std::move(f));
+    }
+    if (frames.empty()) {
+        fprintf(stderr, "[ERRO] Corpus vazio: %s/index.csv\n", dir.c_str());
+        return false;
+    }
+
+    std::vector<CorpusEntry> entries;
+    for (const auto& f : frames) entries.push_back(f.entry);
+    std::vector<uint64_t> atMs;
+    sessions = corpusReplayOffsets(entries, atMs);
+    for (size_t i = 0; i < frames.size(); i++) frames[i].atMs = atMs[i];
+    return true;
+}
+
+bool OutageSchedule::add(const char* spec) {
+    const char* colon = strchr(spec, ':');
+    if (!colon) return false;
+    double start = (double)strtoull(spec, nullptr, 10);
+    windows_.push_back({start, start + (double)strtoull(colon + 1, nullptr, 10)});
+    return true;
+}
+
+bool OutageSchedule::active(double nowMs) const {
+    for (const auto& w : windows_) {
+        if (nowMs >= w.startMs && nowMs < w.endMs) return true;
+    }
+    return false;
+}
+
+bool selectBackend(const std::string& spec, BackendStub& stub, DeviceConfig& dev) {
+    if (spec.empty()) {
+        if (!stub.start(0)) {
+            fprintf(stderr, "[ERRO] Falha ao iniciar backend local.\n");
+            return false;
+        }
+        dev.host = "127.0.0.1";
+        dev.port = stub.port();
+        return true;
+    }
+    size_t colon = spec.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+        fprintf(stderr, "[ERRO] Backend inválido (esperado HOST:PORTA): %s\n", spec.c_str());
+        return false;
+    }
+    dev.host = spec.substr(0, colon);
+    dev.port = (uint16_t)strtoul(spec.c_str() + colon + 1, nullptr, 10);
+
+    // Falha logo em vez de cada POST esperar HTTP_CONNECT_TIMEOUT_MS
+    HttpClient probe;
+    if (!probe.connect(dev.host, dev.port)) {
+        fprintf(stderr, "[ERRO] Backend inacessível: %s\n", spec.c_str());
+        return false;
+    }
+    return true;
+}
+
+void applyServerOutages(DeviceSim& sim, BackendStub& stub, const OutageSchedule& serverOutages) {
+    if (serverOutages.size() == 0) return;
+    sim.setPostHook([&stub, &serverOutages](double nowMs) { stub.setAvailable(!serverOutages.active(nowMs)); });
+}
+
+void printBackendReport(const BackendStats& b) {
+    printf("\nBackend local:\n");
+    printf("  requisições=%llu  200=%llu  rejeitadas=%llu  perdidas=%llu  conexões=%llu\n",
+           (unsigned long long)b.requests, (unsigned long long)b.accepted, (unsigned long long)b.rejected,
+           (unsigned long long)b.dropped, (unsigned long long)b.connections);
+    printf("  fora do ar: 503=%llu  conexões recusadas=%llu\n",
+           (unsigned long long)b.unavailable, (unsigned long long)b.refused);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// Peças comuns aos drivers de host (corpus_replay e load_generator):
+// carga do corpus, janelas de queda e seleção do backend.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "attendance_corpus.h"
+#include "backend_stub.h"
+#include "device_sim.h"
+
+struct CorpusFrame {
+    CorpusEntry entry;
+    std::vector<uint8_t> jpeg;
+    uint64_t atMs = 0; // instante de disponibilidade no relógio do replay
+};
+
+// Lê index.csv e os JPEGs, validando presença e tamanho de cada frame.
+// atMs e sessions vêm de corpusReplayOffsets() (reboots viram novas sessões).
+bool loadCorpus(const std::string& dir, std::vector<CorpusFrame>& frames, uint32_t& sessions);
+
+// Janelas [inicio, fim) em ms no relógio do dispositivo
+class OutageSchedule {
+public:
+    // Formato "INICIO_MS:DURACAO_MS"
+    bool add(const char* spec);
+    bool active(double nowMs) const;
+    size_t size() const { return windows_.size(); }
+
+private:
+    struct Window {
+        double startMs;
+        double endMs;
+    };
+    std::vector<Window> windows_;
+};
+
+// Sem spec, inicia o stub local em porta livre; com "HOST:PORTA", aponta para
+// um servidor externo, que precisa aceitar uma conexão de teste.
+// Preenche dev.host/dev.port. Mensagem de erro em stderr.
+bool selectBackend(const std::string& spec, BackendStub& stub, DeviceConfig& dev);
+
+// Liga a disponibilidade do stub às janelas de --server-outage, avaliadas no
+// relógio do dispositivo antes de cada POST
+void applyServerOutages(DeviceSim& sim, BackendStub& stub, const OutageSchedule& serverOutages);
+
+void printBackendReport(const BackendStats& b);
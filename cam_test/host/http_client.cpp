@@ -0,0 +1,171 @@
+#include "http_client.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+#include "attendance_payload.h"
+
+HttpClient::~HttpClient() {
+    stop();
+}
+
+bool HttpClient::connect(const std::string& host, uint16_t port) {
+    stop();
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = nullptr;
+    std::string portStr = std::to_string(port);
+    if (getaddrinfo(host.c_str(), portStr.c_str(), &hints, &res) != 0 || !res) return false;
+
+    int fd = ::socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd < 0) { freeaddrinfo(res); return false; }
+
+    // connect não bloqueante com timeout, como o WiFiClientSecure: um backend
+    // inalcançável falha em HTTP_CONNECT_TIMEOUT_MS, e não no tempo de SYN do kernel
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int rc = ::connect(fd, res->ai_addr, res->ai_addrlen);
+    freeaddrinfo(res);
+    if (rc != 0) {
+        int err = errno;
+        if (err == EINPROGRESS) {
+            pollfd p{fd, POLLOUT, 0};
+            socklen_t len = sizeof(err);
+            if (poll(&p, 1, (int)HTTP_CONNECT_TIMEOUT_MS) == 1 && getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0) {
+                rc = err == 0 ? 0 : -1;
+            }
+        }
+        if (rc != 0) {
+            ::close(fd);
+            return false;
+        }
+    }
+    fcntl(fd, F_SETFL, flags);
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fd_ = fd;
+    buf_.clear();
+    connects_++;
+    return true;
+}
+
+bool HttpClient::connected() {
+    if (fd_ < 0) return false;
+    pollfd p{fd_, POLLIN, 0};
+    if (poll(&p, 1, 0) > 0) {
+        if (p.revents & (POLLERR | POLLHUP)) { stop(); return false; }
+        char c;
+        ssize_t n = recv(fd_, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+        if (n == 0) { stop(); return false; } // FIN do servidor
+    }
+    return true;
+}
+
+void HttpClient::stop() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    buf_.clear();
+}
+
+bool HttpClient::write(const std::string& data) {
+    if (fd_ < 0) return false;
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t n = ::send(fd_, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            stop();
+            return false;
+        }
+        off += (size_t)n;
+    }
+    return true;
+}
+
+bool HttpClient::fillBuffer(uint32_t timeoutMs) {
+    pollfd p{fd_, POLLIN, 0};
+    int r = poll(&p, 1, (int)timeoutMs);
+    if (r <= 0) return false;
+    char tmp[4096];
+    ssize_t n = ::recv(fd_, tmp, sizeof(tmp), 0);
+    if (n <= 0) return false;
+    buf_.append(tmp, (size_t)n);
+    return true;
+}
+
+bool HttpClient::readResponse(uint32_t timeoutMs, std::string& statusLine, size_t& bytesRead) {
+    statusLine.clear();
+    bytesRead = 0;
+    if (fd_ < 0) return false;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    auto remainingMs = [&]() -> uint32_t {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        return left > 0 ? (uint32_t)left : 0;
+    };
+
+    // Sem linha de status dentro do prazo: falha, como no firmware
+    size_t eol;
+    while ((eol = buf_.find("\r\n")) == std::string::npos) {
+        uint32_t left = remainingMs();
+        if (left == 0 || !fillBuffer(left)) { stop(); return false; }
+    }
+    statusLine = buf_.substr(0, eol);
+
+    // Daqui em diante o resultado é a linha de status; qualquer resto incompleto
+    // só impede reutilizar a conexão
+    size_t headerEnd;
+    while ((headerEnd = buf_.find("\r\n\r\n")) == std::string::npos) {
+        uint32_t left = remainingMs();
+        if (left == 0 || !fillBuffer(left)) {
+            bytesRead = buf_.size();
+            stop();
+            return true;
+        }
+    }
+
+    bool hasLength = false;
+    size_t contentLength = 0;
+    size_t pos = eol + 2;
+    while (pos < headerEnd) {
+        size_t next = buf_.find("\r\n", pos);
+        std::string h = buf_.substr(pos, next - pos);
+        if (strncasecmp(h.c_str(), "Content-Length:", 15) == 0) {
+            contentLength = (size_t)strtoul(h.c_str() + 15, nullptr, 10);
+            hasLength = true;
+        }
+        pos = next + 2;
+    }
+
+    size_t total = headerEnd + 4 + contentLength;
+    while (hasLength && buf_.size() < total) {
+        uint32_t left = remainingMs();
+        if (left == 0 || !fillBuffer(left)) break;
+    }
+    if (!hasLength || buf_.size() < total) {
+        // Sem Content-Length não há como achar o fim do corpo
+        bytesRead = buf_.size();
+        stop();
+        return true;
+    }
+    buf_.erase(0, total);
+    bytesRead = total;
+    return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Cliente TCP mínimo com keep-alive, equivalente ao uso que o firmware faz
+// do WiFiClientSecure (connect / connected / write / leitura da resposta).
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class HttpClient {
+public:
+    HttpClient() = default;
+    ~HttpClient();
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    // Desiste após HTTP_CONNECT_TIMEOUT_MS
+    bool connect(const std::string& host, uint16_t port);
+    // false se o socket foi fechado (localmente ou pelo servidor)
+    bool connected();
+    void stop();
+
+    bool write(const std::string& data);
+
+    // Mesmo contrato de readHttpResponse() no firmware: false (e conexão fechada)
+    // se a linha de status não chegar no prazo; com a linha de status, true. Se os
+    // cabeçalhos ou o corpo não chegarem, ou faltar Content-Length, a conexão é
+    // fechada, pois o resto da resposta ficaria misturado com a próxima.
+    bool readResponse(uint32_t timeoutMs, std::string& statusLine, size_t& bytesRead);
+
+    // Número de conexões TCP abertas por este cliente (handshakes)
+    uint32_t connectCount() const { return connects_; }
+
+private:
+    bool fillBuffer(uint32_t timeoutMs);
+
+    int fd_ = -1;
+    std::string buf_;
+    uint32_t connects_ = 0;
+};
@@ -0,0 +1,283 @@
+// Gerador de carga: simula N câmeras contra um único backend de presença.
+// Cada dispositivo roda o mesmo pipeline do loop() (DeviceSim) em tempo real,
+// em sua própria thread, com cadência de captura própria, keep-alive opcional
+// e fila offline que é drenada quando o Wi-Fi do campus volta.
+//
+// Uso:
+//   load_generator --devices N [--duration-s S] [--interval-ms N] [--interval-jitter-ms N]
+//                  [--frame-bytes N] [--corpus DIR] [--outage INICIO_MS:DURACAO_MS]...
+//                  [--keepalive-fraction F] [--seed N] [--backend HOST:PORTA]
+//                  [--latency-ms N] [--jitter-ms N] [--loss P] [--drain-limit-s S]
+//                  [--server-outage INICIO_MS:DURACAO_MS]...
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "attendance_payload.h"
+#include "backend_stub.h"
+#include "device_sim.h"
+#include "host_common.h"
+#include "stats.h"
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct LoadConfig {
+    uint32_t devices = 10;
+    uint64_t durationMs = 60 * 1000;
+    uint64_t drainLimitMs = 5 * 60 * 1000;
+    uint32_t intervalMs = 3000;
+    uint32_t intervalJitterMs = 1000;
+    uint32_t frameBytes = 9000;
+    double keepAliveFraction = 1.0;
+    uint32_t seed = 1;
+    OutageSchedule outages;
+    OutageSchedule serverOutages;
+};
+
+struct DeviceResult {
+    DeviceStats stats;
+    size_t pending = 0;
+    uint32_t connects = 0;
+    uint32_t intervalMs = 0;
+    bool keepAlive = true;
+};
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Uso: %s --devices N [--duration-s S] [--interval-ms N] [--interval-jitter-ms N]\n"
+            "          [--frame-bytes N] [--corpus DIR] [--outage INICIO_MS:DURACAO_MS]...\n"
+            "          [--keepalive-fraction F] [--seed N] [--backend HOST:PORTA]\n"
+            "          [--latency-ms N] [--jitter-ms N] [--loss P] [--drain-limit-s S]\n"
+            "          [--server-outage INICIO_MS:DURACAO_MS]...\n",
+            argv0);
+}
+
+// Frames do corpus, se informado (mesma validação do corpus_replay);
+// caso contrário JPEGs sintéticos (±30% de frameBytes)
+static bool loadFrames(const std::string& corpusDir, const LoadConfig& cfg, std::vector<std::vector<uint8_t>>& frames) {
+    if (!corpusDir.empty()) {
+        std::vector<CorpusFrame> corpus;
+        uint32_t sessions = 0;
+        if (!loadCorpus(corpusDir, corpus, sessions)) return false;
+        for (auto& f : corpus) frames.push_back(std::move(f.jpeg));
+        return true;
+    }
+
+    std::mt19937 rng(cfg.seed);
+    std::uniform_int_distribution<uint32_t> size(cfg.frameBytes * 7 / 10, cfg.frameBytes * 13 / 10);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (int i = 0; i < 32; i++) {
+        std::vector<uint8_t> f(std::max<uint32_t>(size(rng), 4));
+        for (auto& b : f) b = (uint8_t)byte(rng);
+        f[0] = 0xFF; f[1] = 0xD8; f[f.size() - 2] = 0xFF; f[f.size() - 1] = 0xD9;
+        frames.push_back(std::move(f));
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    LoadConfig cfg;
+    FaultConfig faults;
+    std::string backend;
+    std::string corpusDir;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--devices" && hasValue) cfg.devices = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--duration-s" && hasValue) cfg.durationMs = strtoull(argv[++i], nullptr, 10) * 1000;
+        else if (a == "--drain-limit-s" && hasValue) cfg.drainLimitMs = strtoull(argv[++i], nullptr, 10) * 1000;
+        else if (a == "--interval-ms" && hasValue) cfg.intervalMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--interval-jitter-ms" && hasValue) cfg.intervalJitterMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--frame-bytes" && hasValue) cfg.frameBytes = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--keepalive-fraction" && hasValue) cfg.keepAliveFraction = strtod(argv[++i], nullptr);
+        else if (a == "--seed" && hasValue) cfg.seed = faults.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--corpus" && hasValue) corpusDir = argv[++i];
+        else if (a == "--backend" && hasValue) backend = argv[++i];
+        else if (a == "--latency-ms" && hasValue) faults.latencyMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--jitter-ms" && hasValue) faults.jitterMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--loss" && hasValue) faults.loss = strtod(argv[++i], nullptr);
+        else if (a == "--outage" && hasValue) {
+            if (!cfg.outages.add(argv[++i])) { usage(argv[0]); return 2; }
+        } else if (a == "--server-outage" && hasValue) {
+            if (!cfg.serverOutages.add(argv[++i])) { usage(argv[0]); return 2; }
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (cfg.devices == 0) { usage(argv[0]); return 2; }
+    if (!backend.empty() && cfg.serverOutages.size() > 0) {
+        fprintf(stderr, "[ERRO] --server-outage só se aplica ao backend local.\n");
+        return 2;
+    }
+
+    std::vector<std::vector<uint8_t>> frames;
+    if (!loadFrames(corpusDir, cfg, frames)) return 1;
+
+    DeviceConfig base;
+    BackendStub stub(faults, base.path, base.token);
+    if (!selectBackend(backend, stub, base)) return 1;
+
+    // Queda de Wi-Fi do campus: a mesma janela vale para todos os dispositivos
+    auto linkUp = [&cfg](double nowMs) { return !cfg.outages.active(nowMs); };
+
+    auto t0 = SteadyClock::now();
+    if (backend.empty()) stub.setEpoch(t0);
+    auto realNowMs = [t0]() {
+        return std::chrono::duration<double, std::milli>(SteadyClock::now() - t0).count();
+    };
+    auto sleepUntil = [t0](double ms) {
+        std::this_thread::sleep_until(t0 + std::chrono::duration_cast<SteadyClock::duration>(std::chrono::duration<double, std::milli>(ms)));
+    };
+
+    std::vector<DeviceResult> results(cfg.devices);
+    std::vector<std::thread> threads;
+    std::mt19937 setupRng(cfg.seed);
+    for (uint32_t d = 0; d < cfg.devices; d++) {
+        // Parâmetros por dispositivo sorteados aqui, na thread principal, para que a
+        // configuração de cada sala seja a mesma entre execuções com a mesma semente
+        uint32_t lo = cfg.intervalMs > cfg.intervalJitterMs ? cfg.intervalMs - cfg.intervalJitterMs : 0;
+        uint32_t interval = std::uniform_int_distribution<uint32_t>(lo, cfg.intervalMs + cfg.intervalJitterMs)(setupRng);
+        interval = std::max(interval, CAPTURE_MIN_INTERVAL_MS);
+        uint64_t startOffset = std::uniform_int_distribution<uint32_t>(0, interval)(setupRng);
+        bool keepAlive = std::uniform_real_distribution<double>(0.0, 1.0)(setupRng) < cfg.keepAliveFraction;
+        size_t firstFrame = std::uniform_int_distribution<size_t>(0, frames.size() - 1)(setupRng);
+
+        DeviceConfig dev = base;
+        char room[16];
+        snprintf(room, sizeof(room), "SALA_%03u", d + 1);
+        dev.roomId = room;
+        dev.keepAlive = keepAlive;
+        results[d].intervalMs = interval;
+        results[d].keepAlive = keepAlive;
+
+        threads.emplace_back([&, d, dev, interval, startOffset, firstFrame]() {
+            DeviceSim sim(dev, linkUp);
+            sim.setWaitHook(sleepUntil);
+            // Relógio do dispositivo ~ tempo real: todas as threads concordam sobre a janela
+            applyServerOutages(sim, stub, cfg.serverOutages);
+
+            double nowMs = (double)startOffset;
+            sleepUntil(nowMs);
+            size_t frame = firstFrame;
+            while (nowMs < cfg.durationMs) {
+                const auto& f = frames[frame++ % frames.size()];
+                double capturedAt = nowMs;
+                double next = sim.step(nowMs, f.data(), f.size());
+                // Cadência própria da sala, nunca abaixo do pacing do firmware
+                next = std::max(next, capturedAt + interval);
+                sleepUntil(next);
+                nowMs = std::max(next, realNowMs());
+            }
+
+            // Fim das capturas: o loop continua drenando até a fila esvaziar
+            double stopAt = nowMs + cfg.drainLimitMs;
+            while (sim.queueLen() > 0 && nowMs < stopAt) {
+                nowMs = sim.idle(nowMs) + CAPTURE_OVERRUN_REST_MS;
+                sleepUntil(nowMs);
+                nowMs = std::max(nowMs, realNowMs());
+            }
+
+            results[d].stats = sim.stats();
+            results[d].pending = sim.queueLen();
+            results[d].connects = sim.connectCount();
+        });
+    }
+    for (auto& t : threads) t.join();
+    double wallMs = realNowMs();
+
+    // Agregação
+    DeviceStats total;
+    size_t pending = 0, peakQueue = 0;
+    uint32_t connects = 0, keepAliveDevices = 0;
+    std::vector<double> ackAtMs;                       // confirmações vistas pelos dispositivos
+    std::map<uint64_t, std::vector<double>> rttByWindow; // janela de 5 s -> RTTs confirmados nela
+    for (const auto& r : results) {
+        const DeviceStats& s = r.stats;
+        total.frames += s.frames;
+        total.sentRealtime += s.sentRealtime;
+        total.queuedOffline += s.queuedOffline;
+        total.drained += s.drained;
+        total.failedPosts += s.failedPosts;
+        total.connectFailures += s.connectFailures;
+        total.bytesSent += s.bytesSent;
+        total.bytesReceived += s.bytesReceived;
+        total.rttMs.insert(total.rttMs.end(), s.rttMs.begin(), s.rttMs.end());
+        total.e2eMs.insert(total.e2eMs.end(), s.e2eMs.begin(), s.e2eMs.end());
+        ackAtMs.insert(ackAtMs.end(), s.ackAtMs.begin(), s.ackAtMs.end());
+        for (size_t i = 0; i < s.ackAtMs.size(); i++) rttByWindow[(uint64_t)(s.ackAtMs[i] / 5000)].push_back(s.rttMs[i]);
+        pending += r.pending;
+        peakQueue = std::max(peakQueue, s.peakQueueLen);
+        connects += r.connects;
+        if (r.keepAlive) keepAliveDevices++;
+    }
+    uint64_t acked = total.sentRealtime + total.drained;
+
+    printf("=== Carga: %u dispositivos, %.0f s de captura ===\n", cfg.devices, cfg.durationMs / 1000.0);
+    printf("Backend: %s:%u%s\n", base.host.c_str(), base.port, backend.empty() ? " (stub local)" : "");
+    printf("Cadência: %u±%u ms  frames=%s  keep-alive=%u/%u  quedas=%zu (servidor=%zu)  seed=%u\n",
+           cfg.intervalMs, cfg.intervalJitterMs, corpusDir.empty() ? "sintéticos" : corpusDir.c_str(),
+           keepAliveDevices, cfg.devices, cfg.outages.size(), cfg.serverOutages.size(), cfg.seed);
+    printf("\nRegistros:\n");
+    printf("  capturados=%llu  tempo-real=%llu  fila-offline=%llu  drenados=%llu  pendentes=%zu\n",
+           (unsigned long long)total.frames, (unsigned long long)total.sentRealtime,
+           (unsigned long long)total.queuedOffline, (unsigned long long)total.drained, pending);
+    printf("  POSTs falhos=%llu  falhas de conexão=%llu  conexões TCP=%u  maior fila=%zu linhas\n",
+           (unsigned long long)total.failedPosts, (unsigned long long)total.connectFailures, connects, peakQueue);
+
+    // Vazão sustentada pelo servidor, pelos instantes em que o stub respondeu 200.
+    // Com --backend externo só há a confirmação no cliente, que inclui o RTT.
+    std::vector<double> acceptedAt = backend.empty() ? stub.acceptedAtMs() : ackAtMs;
+    double endMs = wallMs;
+    for (double t : acceptedAt) endMs = std::max(endMs, t);
+    std::vector<uint32_t> perSecond((size_t)(endMs / 1000) + 1, 0);
+    for (double t : acceptedAt) perSecond[(size_t)(t / 1000)]++;
+    size_t peakSecond = 0;
+    for (size_t i = 0; i < perSecond.size(); i++) {
+        if (perSecond[i] > perSecond[peakSecond]) peakSecond = i;
+    }
+    printf("\nVazão do servidor (%s):\n", backend.empty() ? "respostas 200 do stub" : "confirmações nos dispositivos");
+    printf("  média=%.2f req/s (%.1f s)  pico=%u req/s (t=%zus)  aceitas=%zu  confirmadas=%llu\n",
+           endMs > 0 ? acceptedAt.size() * 1000.0 / endMs : 0.0, endMs / 1000.0, perSecond[peakSecond], peakSecond,
+           acceptedAt.size(), (unsigned long long)acked);
+    printf("  bytes: enviados=%llu  recebidos=%llu  (%.1f KiB/s de entrada no servidor)\n",
+           (unsigned long long)total.bytesSent, (unsigned long long)total.bytesReceived,
+           wallMs > 0 ? total.bytesSent / 1024.0 * 1000.0 / wallMs : 0.0);
+
+    printf("\nLatência:\n");
+    printLatencyLine("POST (RTT)", total.rttMs);
+    printf("  %-22s p99.9=%8.1f ms\n", "", percentile(total.rttMs, 99.9));
+    printLatencyLine("captura -> confirmação", total.e2eMs);
+
+    // Linha do tempo em janelas de 5 s, do início ao fim da execução (inclusive janelas
+    // sem respostas, como durante a queda): mostra a tempestade de drenagem depois dela.
+    // req/s vem do servidor; os percentis são do RTT visto pelos dispositivos.
+    printf("\nLinha do tempo (janelas de 5 s):\n");
+    printf("  %8s %8s %10s %10s\n", "t(s)", "req/s", "p50(ms)", "p99(ms)");
+    for (size_t w = 0; w * 5 < perSecond.size(); w++) {
+        uint32_t count = 0;
+        for (size_t i = w * 5; i < std::min(w * 5 + 5, perSecond.size()); i++) count += perSecond[i];
+        const std::vector<double>& rtt = rttByWindow[w];
+        if (rtt.empty()) {
+            printf("  %8zu %8.1f %10s %10s\n", w * 5, count / 5.0, "-", "-");
+        } else {
+            printf("  %8zu %8.1f %10.1f %10.1f\n", w * 5, count / 5.0, percentile(rtt, 50), percentile(rtt, 99));
+        }
+    }
+
+    if (backend.empty()) {
+        BackendStats b = stub.stats();
+        stub.stop();
+        printBackendReport(b);
+    }
+
+    return pending == 0 ? 0 : 3;
+}
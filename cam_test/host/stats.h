@@ -0,0 +1,22 @@
+#pragma once
+
+// Utilitários de estatística usados nos relatórios das ferramentas de host.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Percentil por ranking mais próximo (p em [0, 100]); 0 se não houver amostras
+inline double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t rank = (size_t)std::ceil(p / 100.0 * samples.size());
+    if (rank == 0) rank = 1;
+    return samples[std::min(rank, samples.size()) - 1];
+}
+
+inline void printLatencyLine(const char* label, const std::vector<double>& ms) {
+    printf("  %-22s n=%-7zu p50=%8.1f  p90=%8.1f  p99=%8.1f  max=%8.1f ms\n",
+           label, ms.size(), percentile(ms, 50), percentile(ms, 90), percentile(ms, 99), percentile(ms, 100));
+}
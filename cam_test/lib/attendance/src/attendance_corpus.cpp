@@ -0,0 +1,66 @@
+#include "attendance_corpus.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "attendance_payload.h"
+
+std::string corpusFrameName(uint32_t seq) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%06u.jpg", (unsigned)seq);
+    return std::string(buf);
+}
+
+std::string formatCorpusIndexLine(const CorpusEntry& e) {
+    std::string line;
+    line += std::to_string(e.seq);
+    line += ',';
+    line += std::to_string(e.millis);
+    line += ',';
+    line += std::to_string(e.len);
+    line += ',';
+    line += e.file;
+    return line;
+}
+
+bool parseCorpusIndexLine(const std::string& line, CorpusEntry& e) {
+    size_t c1 = line.find(',');
+    if (c1 == std::string::npos) return false;
+    size_t c2 = line.find(',', c1 + 1);
+    if (c2 == std::string::npos) return false;
+    size_t c3 = line.find(',', c2 + 1);
+    if (c3 == std::string::npos) return false;
+
+    // Campos vazios (",,") também são rejeitados, não lidos como 0
+    char* end = nullptr;
+    e.seq = (uint32_t)strtoul(line.c_str(), &end, 10);
+    if (c1 == 0 || end != line.c_str() + c1) return false;
+    e.millis = (uint32_t)strtoul(line.c_str() + c1 + 1, &end, 10);
+    if (c2 == c1 + 1 || end != line.c_str() + c2) return false;
+    e.len = (size_t)strtoul(line.c_str() + c2 + 1, &end, 10);
+    if (c3 == c2 + 1 || end != line.c_str() + c3) return false;
+
+    e.file = line.substr(c3 + 1);
+    // Remove '\r' de arquivos gravados com println
+    while (!e.file.empty() && (e.file.back() == '\r' || e.file.back() == '\n' || e.file.back() == ' ')) {
+        e.file.pop_back();
+    }
+    return !e.file.empty();
+}
+
+uint32_t corpusReplayOffsets(const std::vector<CorpusEntry>& entries, std::vector<uint64_t>& atMs) {
+    atMs.clear();
+    atMs.reserve(entries.size());
+    uint32_t sessions = 0;
+    uint64_t sessionStartMs = 0;
+    uint32_t sessionMillis0 = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (i == 0 || entries[i].millis < entries[i - 1].millis) {
+            sessionStartMs = (i == 0) ? 0 : atMs.back() + CAPTURE_MIN_INTERVAL_MS;
+            sessionMillis0 = entries[i].millis;
+            sessions++;
+        }
+        atMs.push_back(sessionStartMs + (entries[i].millis - sessionMillis0));
+    }
+    return sessions;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// Formato do corpus de frames gravado pelo modo de captura do firmware
+// (ENABLE_CORPUS_CAPTURE) e consumido pelo driver de replay no host.
+//
+// Estrutura no cartão SD:
+//   /corpus/index.csv      -> uma linha por frame: "seq,millis,len,arquivo"
+//   /corpus/000001.jpg     -> JPEG bruto exatamente como saiu do camera_fb_t
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+static const char* const CORPUS_DIR = "/corpus";
+static const char* const CORPUS_INDEX_FILE = "/corpus/index.csv";
+
+struct CorpusEntry {
+    uint32_t seq = 0;
+    uint32_t millis = 0; // millis() do dispositivo no momento da captura
+    size_t len = 0;      // camera_fb_t::len
+    std::string file;    // nome relativo ao diretório do corpus
+};
+
+std::string corpusFrameName(uint32_t seq);
+std::string formatCorpusIndexLine(const CorpusEntry& e);
+// Retorna false para linhas vazias ou malformadas
+bool parseCorpusIndexLine(const std::string& line, CorpusEntry& e);
+
+// Instante de replay (ms) de cada entrada, na ordem do índice. millis() recomeça
+// em 0 a cada boot e initCorpus() continua um corpus existente: uma queda de
+// millis marca uma nova sessão, que começa CAPTURE_MIN_INTERVAL_MS após o frame
+// anterior. Retorna o número de sessões.
+uint32_t corpusReplayOffsets(const std::vector<CorpusEntry>& entries, std::vector<uint64_t>& atMs);
@@ -0,0 +1,100 @@
+#include "attendance_payload.h"
+
+std::string base64Encode(const uint8_t* data, size_t len) {
+    static const char* tbl = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve(((len + 2) / 3) * 4);
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t n = (uint32_t)data[i] << 16;
+        if (i + 1 < len) n |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < len) n |= (uint32_t)data[i + 2];
+        out += tbl[(n >> 18) & 63];
+        out += tbl[(n >> 12) & 63];
+        out += (i + 1 < len) ? tbl[(n >> 6) & 63] : '=';
+        out += (i + 2 < len) ? tbl[n & 63] : '=';
+    }
+    return out;
+}
+
+std::vector<uint8_t> base64Decode(const std::string& s) {
+    static const int8_t map[256] = {
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,62,-1,-1,-1,63,
+        52,53,54,55,56,57,58,59,60,61,-1,-1,-1, 0,-1,-1,
+        -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,
+        15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1,
+        -1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,
+        41,42,43,44,45,46,47,48,49,50,51,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
+        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+    };
+    std::vector<uint8_t> out;
+    out.reserve((s.size() * 3) / 4);
+    int val = 0, valb = -8;
+    for (size_t i = 0; i < s.size(); i++) {
+        unsigned char c = s[i];
+        if (c == '=') break;
+        int8_t d = map[c];
+        if (d == -1) continue;
+        val = (val << 6) + d;
+        valb += 6;
+        if (valb >= 0) {
+            out.push_back((uint8_t)((val >> valb) & 0xFF));
+            valb -= 8;
+        }
+    }
+    return out;
+}
+
+std::string makeAttendanceJson(const std::string& imageBase64, const std::string& timestampIso, const std::string& roomId, const std::string& courseId, const std::string& mode, const std::string& identity) {
+    std::string j;
+    // Reserva o tamanho final para evitar realocações do Base64 (dezenas de KB)
+    j.reserve(imageBase64.size() + timestampIso.size() + roomId.size() + courseId.size() + mode.size() + identity.size() + 96);
+    j += "{";
+    j += "\"ts\":\""; j += timestampIso; j += "\",";
+    j += "\"room\":\""; j += roomId; j += "\",";
+    j += "\"course\":\""; j += courseId; j += "\",";
+    j += "\"mode\":\""; j += mode; j += "\",";
+    j += "\"identity\":\""; j += identity; j += "\",";
+    j += "\"image_b64\":\""; j += imageBase64; j += "\"";
+    j += "}";
+    return j;
+}
+
+std::string makeAttendanceRequest(const char* host, const char* path, const char* bearerToken, const std::string& jsonPayload) {
+    std::string req;
+    req.reserve(jsonPayload.size() + 256);
+    req += "POST ";
+    req += path;
+    req += " HTTP/1.1\r\nHost: ";
+    req += host;
+    req += "\r\nUser-Agent: ESP32-CAM\r\nConnection: keep-alive\r\nAccept: application/json\r\nContent-Type: application/json\r\nAuthorization: Bearer ";
+    req += bearerToken;
+    req += "\r\nContent-Length: ";
+    req += std::to_string(jsonPayload.size());
+    req += "\r\n\r\n";
+    req += jsonPayload;
+    return req;
+}
+
+bool isHttpSuccessStatus(const std::string& statusLine) {
+    // Mesmo critério do firmware original: código encontrado após o início da linha
+    size_t pos200 = statusLine.find("200");
+    size_t pos201 = statusLine.find("201");
+    size_t pos204 = statusLine.find("204");
+    return (pos200 != std::string::npos && pos200 > 0) ||
+           (pos201 != std::string::npos && pos201 > 0) ||
+           (pos204 != std::string::npos && pos204 > 0);
+}
+
+size_t offlineLineSize(size_t jsonLen) {
+    size_t padded = jsonLen + (16 - (jsonLen % 16)); // PKCS#7
+    return ((padded + 2) / 3) * 4 + 2; // println grava "\r\n"
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// Montagem do payload e da requisição HTTP de presença.
+// Código C++ puro (sem Arduino) para ser compartilhado entre o firmware
+// e as ferramentas de host (cam_test/host), garantindo que ambos gerem
+// exatamente os mesmos bytes na rede.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ===================== TEMPORIZAÇÃO DO PIPELINE =====================
+
+// Intervalo mínimo entre capturas consecutivas
+static const uint32_t CAPTURE_MIN_INTERVAL_MS = 1500;
+// Pausa aplicada quando o processamento já excedeu o intervalo mínimo
+static const uint32_t CAPTURE_OVERRUN_REST_MS = 100;
+// Intervalo entre tentativas de drenagem da fila offline
+static const uint32_t SYNC_INTERVAL_MS = 10000;
+// connectWiFi() bloqueia até conectar ou até este timeout, consultando a cada POLL
+static const uint32_t WIFI_CONNECT_TIMEOUT_MS = 20000;
+static const uint32_t WIFI_CONNECT_POLL_MS = 250;
+// Tempo máximo de espera pela resposta HTTP (linha de status, cabeçalhos e corpo)
+static const uint32_t HTTP_RESPONSE_TIMEOUT_MS = 2000;
+// Timeout de client.connect(): o padrão do WiFiClientSecure, que o firmware não altera
+static const uint32_t HTTP_CONNECT_TIMEOUT_MS = 30000;
+
+// Timestamp usado enquanto o NTP ainda não sincronizou
+static const char* const TIMESTAMP_FALLBACK = "1970-01-01T00:00:00Z";
+
+// ===================== CODIFICAÇÃO =====================
+
+std::string base64Encode(const uint8_t* data, size_t len);
+std::vector<uint8_t> base64Decode(const std::string& s);
+
+// ===================== PAYLOAD E REQUISIÇÃO =====================
+
+std::string makeAttendanceJson(const std::string& imageBase64, const std::string& timestampIso, const std::string& roomId, const std::string& courseId, const std::string& mode, const std::string& identity);
+
+// Requisição HTTP/1.1 completa (cabeçalhos + corpo) com keep-alive
+std::string makeAttendanceRequest(const char* host, const char* path, const char* bearerToken, const std::string& jsonPayload);
+
+// Considera sucesso se a linha de status contiver 200, 201 ou 204
+bool isHttpSuccessStatus(const std::string& statusLine);
+
+// Tamanho da linha gravada na fila offline: Base64(AES-128-CBC(json)) + "\r\n"
+size_t offlineLineSize(size_t jsonLen);
@@ -9,8 +9,12 @@
 #include "mbedtls/aes.h"
 #include <vector>
 #include <memory>
+#include <string>
 #include <cstring> // Adicionado para operações de string/memória
 
+// Payload e requisição compartilhados com as ferramentas de host (lib/attendance)
+#include "attendance_payload.h"
+
 // Ativa ou desativa a funcionalidade de Validação via Bluetooth Low Energy (BLE)
 #define ENABLE_BLE 1
 #if ENABLE_BLE
@@ -18,6 +22,14 @@
 #include <NimBLEDevice.h>
 #endif
 
+// Grava cada frame capturado (JPEG bruto + millis) no cartão SD para replay no host.
+// Usa o SD_MMC em modo 1-bit para não conflitar com o LED de flash (GPIO 4).
+#define ENABLE_CORPUS_CAPTURE 0
+#if ENABLE_CORPUS_CAPTURE
+#include <SD_MMC.h>
+#include "attendance_corpus.h"
+#endif
+
 // ===================== PINOUT DA CÂMERA (ESP32-CAM) =====================
 #define PWDN_GPIO_NUM       32
 #define RESET_GPIO_NUM      -1
@@ -102,17 +114,20 @@ static void logError(const __FlashStringHelper* msg);
 static void logError(const char* msg); // Sobrecarga para strings dinâmicas
 static void connectWiFi();
 static bool initCamera();
-static String base64Encode(const uint8_t* data, size_t len);
 static std::vector<uint8_t> aesCbcEncrypt(const uint8_t* plaintext, size_t len);
 static std::vector<uint8_t> aesCbcDecrypt(const uint8_t* ciphertext, size_t len);
-static bool appendEncryptedOfflineLine(const String& jsonLine);
+static bool appendEncryptedOfflineLine(const std::string& jsonLine);
 static bool tryDrainOfflineQueue(WiFiClientSecure& client);
+static bool readHttpResponse(WiFiClientSecure& client, String& status);
 static bool captureJpeg(std::unique_ptr<camera_fb_t, void(*)(camera_fb_t*)>& fbPtr);
-static String makeAttendanceJson(const String& imageBase64, const String& timestampIso, const String& roomId, const String& courseId, const String& mode, const String& identity);
-static bool postAttendance(WiFiClientSecure& client, const String& jsonPayload);
+static bool postAttendance(WiFiClientSecure& client, const std::string& jsonPayload);
 #if ENABLE_BLE
 static void initBLE();
 #endif
+#if ENABLE_CORPUS_CAPTURE
+static bool initCorpus();
+static void saveCorpusFrame(const camera_fb_t* fb);
+#endif
 
 // ===================== UTILITÁRIOS E LOGS =====================
 
@@ -157,8 +172,8 @@ static void connectWiFi() {
     WiFi.mode(WIFI_STA);
     WiFi.begin(WIFI_SSID, WIFI_PASS);
     uint32_t start = millis();
-    while (WiFi.status() != WL_CONNECTED && millis() - start < 20000) {
-        delay(250);
+    while (WiFi.status() != WL_CONNECTED && millis() - start < WIFI_CONNECT_TIMEOUT_MS) {
+        delay(WIFI_CONNECT_POLL_MS);
         Serial.print(".");
     }
     Serial.println();
@@ -216,23 +231,6 @@ static bool initCamera() {
 
 // ===================== CRIPTOGRAFIA (AES-128 CBC) =====================
 
-// Função Base64 Encode mantida
-static String base64Encode(const uint8_t* data, size_t len) {
-    static const char* tbl = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    String out;
-    out.reserve((len * 4) / 3 + 4);
-    for (size_t i = 0; i < len; i += 3) {
-        uint32_t n = (uint32_t)data[i] << 16;
-        if (i + 1 < len) n |= (uint32_t)data[i + 1] << 8;
-        if (i + 2 < len) n |= (uint32_t)data[i + 2];
-        out += tbl[(n >> 18) & 63];
-        out += tbl[(n >> 12) & 63];
-        out += (i + 1 < len) ? tbl[(n >> 6) & 63] : '=';
-        out += (i + 2 < len) ? tbl[n & 63] : '=';
-    }
-    return out;
-}
-
 // Função AES Encrypt mantida (PKCS#7 padding interno)
 static std::vector<uint8_t> aesCbcEncrypt(const uint8_t* plaintext, size_t len) {
     mbedtls_aes_context ctx;
@@ -299,57 +297,20 @@ static std::vector<uint8_t> aesCbcDecrypt(const uint8_t* ciphertext, size_t len)
 
 // ===================== ARMAZENAMENTO OFFLINE (SPIFFS) =====================
 
-static bool appendEncryptedOfflineLine(const String& jsonLine) {
-    auto enc = aesCbcEncrypt((const uint8_t*)jsonLine.c_str(), jsonLine.length());
+static bool appendEncryptedOfflineLine(const std::string& jsonLine) {
+    auto enc = aesCbcEncrypt((const uint8_t*)jsonLine.data(), jsonLine.size());
     if (enc.empty()) {
         logError(F("Erro na criptografia. Não salvo."));
         return false;
     }
-    String b64 = base64Encode(enc.data(), enc.size());
+    std::string b64 = base64Encode(enc.data(), enc.size());
     File f = SPIFFS.open(OFFLINE_FILE, FILE_APPEND);
     if (!f) { logError(F("Falha ao abrir SPIFFS para APPEND.")); return false; }
-    f.println(b64);
+    f.println(b64.c_str());
     f.close();
     return true;
 }
 
-// Refatoração de Base64 Decode em uma função separada para clareza
-static std::vector<uint8_t> b64ToBin(const String& s) {
-    static const int8_t map[256] = {
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,62,-1,-1,-1,63,
-        52,53,54,55,56,57,58,59,60,61,-1,-1,-1, 0,-1,-1,
-        -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,
-        15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1,
-        -1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,
-        41,42,43,44,45,46,47,48,49,50,51,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
-        -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
-    };
-    std::vector<uint8_t> out;
-    int val = 0, valb = -8;
-    for (size_t i = 0; i < s.length(); i++) {
-        unsigned char c = s[i];
-        if (c == '=') break;
-        int8_t d = map[c];
-        if (d == -1) continue;
-        val = (val << 6) + d;
-        valb += 6;
-        if (valb >= 0) {
-            out.push_back((uint8_t)((val >> valb) & 0xFF));
-            valb -= 8;
-        }
-    }
-    return out;
-}
-
 // Implementação da drenagem da fila offline (TRY DRAIN)
 static bool tryDrainOfflineQueue(WiFiClientSecure& client) {
     if (!SPIFFS.exists(OFFLINE_FILE)) return true;
@@ -365,7 +326,7 @@ static bool tryDrainOfflineQueue(WiFiClientSecure& client) {
         b64.trim();
         if (b64.isEmpty()) continue;
 
-        std::vector<uint8_t> enc = b64ToBin(b64);
+        std::vector<uint8_t> enc = base64Decode(std::string(b64.c_str(), b64.length()));
         if (enc.empty() || enc.size() % 16 != 0) { 
             logError(F("Linha offline (B64/AES) inválida, descartando."));
             allSent = false; 
@@ -379,8 +340,8 @@ static bool tryDrainOfflineQueue(WiFiClientSecure& client) {
             continue;
         }
 
-        String jsonLine = String((const char*)plain.data());
-        jsonLine.trim();
+        // O texto decifrado não é terminado em '\0'; usa o tamanho explícito
+        std::string jsonLine((const char*)plain.data(), plain.size());
 
         // Envia linha ao servidor
         if (!WiFi.isConnected()) { 
@@ -400,27 +361,13 @@ static bool tryDrainOfflineQueue(WiFiClientSecure& client) {
                 }
             }
             // HTTP POST Request
-            String req;
-            req += F("POST ");
-            req += SERVER_ATTENDANCE_PATH;
-            req += F(" HTTP/1.1\r\nHost: ");
-            req += SERVER_ADDRESS;
-            req += F("\r\nUser-Agent: ESP32-CAM\r\nConnection: keep-alive\r\nAccept: application/json\r\nContent-Type: application/json\r\nAuthorization: Bearer ");
-            req += AUTH_BEARER_TOKEN;
-            req += F("\r\nContent-Length: ");
-            req += String(jsonLine.length());
-            req += F("\r\n\r\n");
-            req += jsonLine;
-
-            client.print(req);
-
-            uint32_t t0 = millis();
-            // Espera pela resposta com timeout
-            while (client.available() == 0 && millis() - t0 < 2000) delay(10); 
-            if (client.available()) {
-                String status = client.readStringUntil('\n'); 
+            std::string req = makeAttendanceRequest(SERVER_ADDRESS, SERVER_ATTENDANCE_PATH, AUTH_BEARER_TOKEN, jsonLine);
+            client.write((const uint8_t*)req.data(), req.size());
+
+            String status;
+            if (readHttpResponse(client, status)) {
                 // Considera sucesso se o status for 2xx
-                ok = status.indexOf(F("200")) > 0 || status.indexOf(F("201")) > 0 || status.indexOf(F("204")) > 0;
+                ok = isHttpSuccessStatus(status.c_str());
             }
         }
         if (!ok) {
@@ -445,6 +392,49 @@ static bool tryDrainOfflineQueue(WiFiClientSecure& client) {
     return allSent;
 }
 
+// Lê a resposta HTTP inteira (status, cabeçalhos e corpo via Content-Length).
+// Com keep-alive, sobras desta resposta seriam lidas como "status" do próximo POST.
+// Retorna false só se a linha de status não chegar; cabeçalhos ou corpo
+// incompletos, ou a falta de Content-Length, apenas fecham a conexão.
+// A réplica no host (HttpClient::readResponse) segue o mesmo contrato.
+static bool readHttpResponse(WiFiClientSecure& client, String& status) {
+    uint32_t t0 = millis();
+    // Espera pela resposta com timeout
+    while (client.available() == 0 && millis() - t0 < HTTP_RESPONSE_TIMEOUT_MS) delay(10);
+    if (!client.available()) {
+        client.stop();
+        return false;
+    }
+
+    status = client.readStringUntil('\n');
+    status.trim();
+
+    int contentLength = -1;
+    bool headersDone = false;
+    while (millis() - t0 < HTTP_RESPONSE_TIMEOUT_MS) {
+        String h = client.readStringUntil('\n');
+        h.trim();
+        if (h.isEmpty()) { headersDone = true; break; }
+        if (h.length() > 15 && h.substring(0, 15).equalsIgnoreCase(F("Content-Length:"))) {
+            contentLength = h.substring(15).toInt();
+        }
+    }
+
+    int remaining = contentLength;
+    uint8_t buf[64];
+    while (remaining > 0 && millis() - t0 < HTTP_RESPONSE_TIMEOUT_MS) {
+        int n = client.available();
+        if (n <= 0) { delay(1); continue; }
+        int r = client.read(buf, (size_t)min(n, min(remaining, (int)sizeof(buf))));
+        if (r > 0) remaining -= r;
+    }
+
+    if (!headersDone || contentLength < 0 || remaining > 0) {
+        client.stop();
+    }
+    return true;
+}
+
 // ===================== BLE (ATIVAÇÃO DO PROFESSOR) =====================
 #if ENABLE_BLE
 static NimBLEServer* g_bleServer = nullptr;
@@ -487,6 +477,55 @@ static void initBLE() {
 }
 #endif
 
+// ===================== CORPUS DE FRAMES (SD) =====================
+#if ENABLE_CORPUS_CAPTURE
+static uint32_t g_corpusSeq = 0;
+static bool g_corpusReady = false;
+
+static bool initCorpus() {
+    // "true" = modo 1-bit (libera o GPIO 4 usado pelo LED de flash)
+    if (!SD_MMC.begin("/sdcard", true)) return false;
+    if (!SD_MMC.exists(CORPUS_DIR) && !SD_MMC.mkdir(CORPUS_DIR)) return false;
+
+    // Continua a numeração de um corpus existente em vez de sobrescrevê-lo
+    File idx = SD_MMC.open(CORPUS_INDEX_FILE, FILE_READ);
+    if (idx) {
+        while (idx.available()) {
+            String line = idx.readStringUntil('\n');
+            CorpusEntry e;
+            if (parseCorpusIndexLine(line.c_str(), e) && e.seq > g_corpusSeq) g_corpusSeq = e.seq;
+        }
+        idx.close();
+    }
+    g_corpusReady = true;
+    logInfo(F("Captura de corpus ativa no cartão SD."));
+    return true;
+}
+
+static void saveCorpusFrame(const camera_fb_t* fb) {
+    if (!g_corpusReady) return;
+
+    CorpusEntry e;
+    e.seq = ++g_corpusSeq;
+    e.millis = millis();
+    e.len = fb->len;
+    e.file = corpusFrameName(e.seq);
+
+    std::string path = std::string(CORPUS_DIR) + "/" + e.file;
+    File f = SD_MMC.open(path.c_str(), FILE_WRITE);
+    if (!f) { logError(F("Falha ao gravar frame do corpus.")); return; }
+    size_t written = f.write(fb->buf, fb->len);
+    f.close();
+    if (written != fb->len) { logError(F("Frame do corpus gravado incompleto.")); return; }
+
+    // O índice só referencia frames gravados por completo
+    File idx = SD_MMC.open(CORPUS_INDEX_FILE, FILE_APPEND);
+    if (!idx) { logError(F("Falha ao abrir índice do corpus.")); return; }
+    idx.println(formatCorpusIndexLine(e).c_str());
+    idx.close();
+}
+#endif
+
 // ===================== CAPTURA E ENVIO =====================
 
 static bool captureJpeg(std::unique_ptr<camera_fb_t, void(*)(camera_fb_t*)>& fbPtr) {
@@ -505,19 +544,7 @@ static bool captureJpeg(std::unique_ptr<camera_fb_t, void(*)(camera_fb_t*)>& fbP
     return true;
 }
 
-static String makeAttendanceJson(const String& imageBase64, const String& timestampIso, const String& roomId, const String& courseId, const String& mode, const String& identity) {
-    String j = F("{");
-    j += F("\"ts\":\"") + timestampIso + F("\",");
-    j += F("\"room\":\"") + roomId + F("\",");
-    j += F("\"course\":\"") + courseId + F("\",");
-    j += F("\"mode\":\"") + mode + F("\","); 
-    j += F("\"identity\":\"") + identity + F("\","); 
-    j += F("\"image_b64\":\"") + imageBase64 + F("\"");
-    j += F("}");
-    return j;
-}
-
-static bool postAttendance(WiFiClientSecure& client, const String& jsonPayload) {
+static bool postAttendance(WiFiClientSecure& client, const std::string& jsonPayload) {
     if (!WiFi.isConnected()) return false;
 
     // Conexão TLS
@@ -533,26 +560,12 @@ static bool postAttendance(WiFiClientSecure& client, const String& jsonPayload)
         }
     }
 
-    String req;
-    req += F("POST ");
-    req += SERVER_ATTENDANCE_PATH;
-    req += F(" HTTP/1.1\r\nHost: ");
-    req += SERVER_ADDRESS;
-    req += F("\r\nUser-Agent: ESP32-CAM\r\nConnection: keep-alive\r\nAccept: application/json\r\nContent-Type: application/json\r\nAuthorization: Bearer ");
-    req += AUTH_BEARER_TOKEN;
-    req += F("\r\nContent-Length: ");
-    req += String(jsonPayload.length());
-    req += F("\r\n\r\n");
-    req += jsonPayload;
-
-    client.print(req);
+    std::string req = makeAttendanceRequest(SERVER_ADDRESS, SERVER_ATTENDANCE_PATH, AUTH_BEARER_TOKEN, jsonPayload);
+    client.write((const uint8_t*)req.data(), req.size());
 
-    uint32_t t0 = millis();
-    while (client.available() == 0 && millis() - t0 < 2000) delay(10);
-    
-    if (client.available()) {
-        String status = client.readStringUntil('\n'); 
-        if (status.indexOf(F("200")) > 0 || status.indexOf(F("201")) > 0 || status.indexOf(F("204")) > 0) {
+    String status;
+    if (readHttpResponse(client, status)) {
+        if (isHttpSuccessStatus(status.c_str())) {
             return true;
         } else {
             // Loga o erro de status HTTP para diagnóstico
@@ -567,7 +580,6 @@ static bool postAttendance(WiFiClientSecure& client, const String& jsonPayload)
 
 // ===================== SETUP E LOOP (Funções padrão Arduino) =====================
 static uint32_t lastSyncAttemptMs = 0;
-static const uint32_t SYNC_INTERVAL_MS = 10000;
 
 void setup() {
     Serial.begin(115200);
@@ -597,6 +609,12 @@ void setup() {
     initBLE();
 #endif
 
+#if ENABLE_CORPUS_CAPTURE
+    if (!initCorpus()) {
+        logError(F("Cartão SD indisponível. Corpus não será gravado."));
+    }
+#endif
+
     logInfo(F("Setup concluído. Loop de captura em execução."));
 }
 
@@ -648,15 +666,19 @@ void loop() {
         return;
     }
 
+#if ENABLE_CORPUS_CAPTURE
+    saveCorpusFrame(fb.get());
+#endif
+
     // 6. Codificação e Montagem do Payload
-    String imgB64 = base64Encode(fb->buf, fb->len);
+    std::string imgB64 = base64Encode(fb->buf, fb->len);
     // Usa o timestamp real se estiver ajustado, caso contrário usa o fallback
-    String ts = timeIsSet() ? iso8601Now() : String(F("1970-01-01T00:00:00Z")); 
+    std::string ts = timeIsSet() ? std::string(iso8601Now().c_str()) : std::string(TIMESTAMP_FALLBACK); 
     
     // O modo de envio é determinado pela conexão Wi-Fi
-    String mode = WiFi.isConnected() ? F("realtime") : F("offline");
+    std::string mode = WiFi.isConnected() ? "realtime" : "offline";
     
-    String payload = makeAttendanceJson(imgB64, ts, SCHOOL_ROOM_ID, COURSE_ID, mode, F(""));
+    std::string payload = makeAttendanceJson(imgB64, ts, SCHOOL_ROOM_ID, COURSE_ID, mode, "");
 
     // 7. Envio ou Armazenamento
     bool ok = false;
@@ -680,6 +702,6 @@ void loop() {
 
     // 8. Controle de Tempo (Garante uma pausa mínima entre capturas)
     // Se o processamento for rápido, espera mais. Mínimo de 1.5s entre capturas.
-    uint32_t rest = (elapsed < 1500) ? (1500 - elapsed) : (100); 
+    uint32_t rest = (elapsed < CAPTURE_MIN_INTERVAL_MS) ? (CAPTURE_MIN_INTERVAL_MS - elapsed) : (CAPTURE_OVERRUN_REST_MS); 
     delay(rest);
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+// Testes nativos (pio test -e native) do formato do corpus de frames e da
+// divisão em sessões usada pelo replay no host.
+
+#include <unity.h>
+
+#include <string>
+#include <vector>
+
+#include "attendance_corpus.h"
+#include "attendance_payload.h"
+
+void setUp() {}
+void tearDown() {}
+
+static void test_parse_crlf_line() {
+    CorpusEntry e;
+    TEST_ASSERT_TRUE(parseCorpusIndexLine("12,345678,9123,000012.jpg\r", e));
+    TEST_ASSERT_EQUAL_UINT32(12, e.seq);
+    TEST_ASSERT_EQUAL_UINT32(345678, e.millis);
+    TEST_ASSERT_EQUAL_UINT32(9123, e.len);
+    TEST_ASSERT_EQUAL_STRING("000012.jpg", e.file.c_str());
+
+    TEST_ASSERT_TRUE(parseCorpusIndexLine("12,345678,9123,000012.jpg\r\n", e));
+    TEST_ASSERT_EQUAL_STRING("000012.jpg", e.file.c_str());
+}
+
+static void test_parse_trailing_space() {
+    CorpusEntry e;
+    TEST_ASSERT_TRUE(parseCorpusIndexLine("1,1500,800,000001.jpg  \r", e));
+    TEST_ASSERT_EQUAL_STRING("000001.jpg", e.file.c_str());
+}
+
+static void test_parse_missing_field() {
+    CorpusEntry e;
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("", e));
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("\r", e));
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("1,1500,800", e));
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("1,1500,800,", e));
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("1,,800,000001.jpg", e));
+    TEST_ASSERT_FALSE(parseCorpusIndexLine(",1500,800,000001.jpg", e));
+}
+
+static void test_parse_non_numeric() {
+    CorpusEntry e;
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("seq,millis,len,file", e));
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("1,15x0,800,000001.jpg", e));
+    TEST_ASSERT_FALSE(parseCorpusIndexLine("1,1500,8 00,000001.jpg", e));
+}
+
+static void test_format_parse_round_trip() {
+    CorpusEntry in;
+    in.seq = 42;
+    in.millis = 4000000000u;
+    in.len = 15000;
+    in.file = corpusFrameName(in.seq);
+    TEST_ASSERT_EQUAL_STRING("000042.jpg", in.file.c_str());
+
+    CorpusEntry out;
+    TEST_ASSERT_TRUE(parseCorpusIndexLine(formatCorpusIndexLine(in), out));
+    TEST_ASSERT_EQUAL_UINT32(in.seq, out.seq);
+    TEST_ASSERT_EQUAL_UINT32(in.millis, out.millis);
+    TEST_ASSERT_EQUAL_UINT32(in.len, out.len);
+    TEST_ASSERT_EQUAL_STRING(in.file.c_str(), out.file.c_str());
+}
+
+static CorpusEntry entryAt(uint32_t seq, uint32_t millis) {
+    CorpusEntry e;
+    e.seq = seq;
+    e.millis = millis;
+    e.file = corpusFrameName(seq);
+    return e;
+}
+
+static void test_offsets_single_session() {
+    std::vector<CorpusEntry> entries = {entryAt(1, 5000), entryAt(2, 6500), entryAt(3, 6500), entryAt(4, 9000)};
+    std::vector<uint64_t> atMs;
+    TEST_ASSERT_EQUAL_UINT32(1, corpusReplayOffsets(entries, atMs));
+    TEST_ASSERT_EQUAL_UINT32(4, atMs.size());
+    TEST_ASSERT_EQUAL_UINT64(0, atMs[0]);
+    TEST_ASSERT_EQUAL_UINT64(1500, atMs[1]);
+    TEST_ASSERT_EQUAL_UINT64(1500, atMs[2]);
+    TEST_ASSERT_EQUAL_UINT64(4000, atMs[3]);
+}
+
+static void test_offsets_split_on_reboot() {
+    // Reboot entre os frames 3 e 4: millis() recomeça perto de zero
+    std::vector<CorpusEntry> entries = {entryAt(1, 5000), entryAt(2, 6500), entryAt(3, 8000),
+                                        entryAt(4, 200), entryAt(5, 1700)};
+    std::vector<uint64_t> atMs;
+    TEST_ASSERT_EQUAL_UINT32(2, corpusReplayOffsets(entries, atMs));
+    TEST_ASSERT_EQUAL_UINT64(3000, atMs[2]);
+    TEST_ASSERT_EQUAL_UINT64(3000 + CAPTURE_MIN_INTERVAL_MS, atMs[3]);
+    TEST_ASSERT_EQUAL_UINT64(3000 + CAPTURE_MIN_INTERVAL_MS + 1500, atMs[4]);
+    for (size_t i = 1; i < atMs.size(); i++) TEST_ASSERT_TRUE(atMs[i] >= atMs[i - 1]);
+}
+
+static void test_offsets_empty() {
+    std::vector<CorpusEntry> entries;
+    std::vector<uint64_t> atMs(3, 7);
+    TEST_ASSERT_EQUAL_UINT32(0, corpusReplayOffsets(entries, atMs));
+    TEST_ASSERT_EQUAL_UINT32(0, atMs.size());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_parse_crlf_line);
+    RUN_TEST(test_parse_trailing_space);
+    RUN_TEST(test_parse_missing_field);
+    RUN_TEST(test_parse_non_numeric);
+    RUN_TEST(test_format_parse_round_trip);
+    RUN_TEST(test_offsets_single_session);
+    RUN_TEST(test_offsets_split_on_reboot);
+    RUN_TEST(test_offsets_empty);
+    return UNITY_END();
+}
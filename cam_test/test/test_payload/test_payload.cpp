@@ -0,0 +1,114 @@
+// Testes nativos (pio test -e native) do código compartilhado entre o
+// firmware e as ferramentas de host: Base64, requisição HTTP, status e
+// tamanho das linhas da fila offline.
+
+#include <unity.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "attendance_payload.h"
+
+void setUp() {}
+void tearDown() {}
+
+static std::string encode(const std::string& s) {
+    return base64Encode((const uint8_t*)s.data(), s.size());
+}
+
+static std::string decode(const std::string& s) {
+    std::vector<uint8_t> bin = base64Decode(s);
+    return std::string(bin.begin(), bin.end());
+}
+
+// Vetores da RFC 4648: comprimentos com resto 0, 1 e 2 na divisão por 3
+static void test_base64_vectors() {
+    TEST_ASSERT_EQUAL_STRING("", encode("").c_str());
+    TEST_ASSERT_EQUAL_STRING("Zg==", encode("f").c_str());
+    TEST_ASSERT_EQUAL_STRING("Zm8=", encode("fo").c_str());
+    TEST_ASSERT_EQUAL_STRING("Zm9v", encode("foo").c_str());
+    TEST_ASSERT_EQUAL_STRING("Zm9vYg==", encode("foob").c_str());
+    TEST_ASSERT_EQUAL_STRING("Zm9vYmE=", encode("fooba").c_str());
+    TEST_ASSERT_EQUAL_STRING("Zm9vYmFy", encode("foobar").c_str());
+}
+
+static void test_base64_round_trip() {
+    // Todos os valores de byte, em comprimentos com resto 0, 1 e 2
+    for (size_t len = 0; len <= 258; len++) {
+        std::vector<uint8_t> data(len);
+        for (size_t i = 0; i < len; i++) data[i] = (uint8_t)((i * 7 + len) & 0xFF);
+        std::string b64 = base64Encode(data.data(), data.size());
+        TEST_ASSERT_EQUAL_UINT32(((len + 2) / 3) * 4, b64.size());
+        std::vector<uint8_t> back = base64Decode(b64);
+        TEST_ASSERT_EQUAL_UINT32(len, back.size());
+        if (len > 0) TEST_ASSERT_EQUAL_UINT8_ARRAY(data.data(), back.data(), len);
+    }
+}
+
+static void test_base64_decode_ignores_line_breaks() {
+    // Linhas da fila offline chegam com o "\r\n" do println
+    TEST_ASSERT_EQUAL_STRING("foobar", decode("Zm9v\r\nYmFy\r\n").c_str());
+}
+
+// Montagem original do firmware (String + F()), reproduzida passo a passo
+static std::string legacyRequest(const char* host, const char* path, const char* token, const std::string& json) {
+    std::string req;
+    req += "POST ";
+    req += path;
+    req += " HTTP/1.1\r\nHost: ";
+    req += host;
+    req += "\r\nUser-Agent: ESP32-CAM\r\nConnection: keep-alive\r\nAccept: application/json\r\nContent-Type: application/json\r\nAuthorization: Bearer ";
+    req += token;
+    req += "\r\nContent-Length: ";
+    req += std::to_string(json.length());
+    req += "\r\n\r\n";
+    req += json;
+    return req;
+}
+
+static void test_request_matches_legacy_bytes() {
+    std::string json = makeAttendanceJson(encode("\xFF\xD8 jpeg \xFF\xD9"), "2024-03-01T12:00:00Z", "SALA_101",
+                                          "DISCIPLINA_ABC123", "auto", "unknown");
+    const char* host = "172.24.153.47";
+    const char* path = "/api/v1/attendance";
+    const char* token = "e83z9XyJk4mFpA6hD7qWc2sT1uVb0R3g";
+    std::string expected = legacyRequest(host, path, token, json);
+    std::string actual = makeAttendanceRequest(host, path, token, json);
+    TEST_ASSERT_EQUAL_UINT32(expected.size(), actual.size());
+    TEST_ASSERT_TRUE(expected == actual);
+}
+
+static void test_http_success_status() {
+    TEST_ASSERT_TRUE(isHttpSuccessStatus("HTTP/1.1 200 OK"));
+    TEST_ASSERT_TRUE(isHttpSuccessStatus("HTTP/1.1 201 Created"));
+    TEST_ASSERT_TRUE(isHttpSuccessStatus("HTTP/1.1 204 No Content"));
+    TEST_ASSERT_FALSE(isHttpSuccessStatus("HTTP/1.1 404"));
+    TEST_ASSERT_FALSE(isHttpSuccessStatus("HTTP/1.1 503 Service Unavailable"));
+    TEST_ASSERT_FALSE(isHttpSuccessStatus(""));
+}
+
+// Linha real da fila: PKCS#7 como em aesEncrypt(), Base64 e o "\r\n" do println
+static size_t storedLineSize(size_t jsonLen) {
+    size_t pad = 16 - (jsonLen % 16);
+    std::vector<uint8_t> cipher(jsonLen + pad, 0xAB);
+    return base64Encode(cipher.data(), cipher.size()).size() + strlen("\r\n");
+}
+
+static void test_offline_line_size() {
+    const size_t lens[] = {0, 1, 15, 16, 17, 31, 32, 47, 48, 1000, 12345};
+    for (size_t len : lens) {
+        TEST_ASSERT_EQUAL_UINT32(storedLineSize(len), offlineLineSize(len));
+    }
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_base64_vectors);
+    RUN_TEST(test_base64_round_trip);
+    RUN_TEST(test_base64_decode_ignores_line_breaks);
+    RUN_TEST(test_request_matches_legacy_bytes);
+    RUN_TEST(test_http_success_status);
+    RUN_TEST(test_offline_line_size);
+    return UNITY_END();
+}